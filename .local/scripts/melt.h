@@ -0,0 +1,103 @@
+/*
+ * libmelt: ed25519 seeds and other entropy <-> BIP39 mnemonics, and OpenSSH
+ * key files to and from memory. melt.c is both the library and the melt CLI:
+ *
+ *   cc -shared -fPIC -fvisibility=hidden -DMELT_NO_MAIN -o libmelt.so melt.c -lcrypto -pthread
+ *
+ * Every function is reentrant and thread-safe: results go to caller buffers,
+ * errors to a caller-supplied err of MELT_ERR_LEN bytes, and nothing here
+ * starts a thread or takes a lock (the CPU feature probe and the Ed25519
+ * table build run once via pthread_once; bcrypt runs on the calling thread).
+ * Hashing, public keys, derivation and combining shares are built in and
+ * never allocate. The calls that reach OpenSSL do, inside it:
+ *   melt_format_private_key  RNG for its check bytes, and with a passphrase
+ *                            the KDF salt and an AES cipher context
+ *   melt_parse_private_key   an AES cipher context for an encrypted key
+ *   melt_split_secret        RNG for the share polynomials and identifier
+ * The RNG sets up per-thread state on first use; a cipher context is
+ * allocated and freed within each call.
+ */
+#ifndef MELT_H
+#define MELT_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MELT_API __attribute__((visibility("default")))
+
+#define MELT_ERR_LEN 256
+#define MELT_MAX_WORDS 24
+#define MELT_MNEMONIC_LEN 256     /* 24 words of at most 8 letters, space separated */
+#define MELT_PRIVATE_KEY_LEN 1024 /* an armored ed25519 private key, encrypted or not */
+#define MELT_PUBLIC_KEY_LEN 128   /* "ssh-ed25519 <base64>\n" */
+#define MELT_NEED_PASSPHRASE -2   /* key is encrypted and no passphrase was given */
+#define MELT_KDF_ROUNDS 16        /* ssh-keygen's default */
+
+/* BIP39 word i (0..2047), and the index of a word or a 4+ letter prefix of one (-1 if none) */
+MELT_API const char *melt_word(int index);
+MELT_API int melt_find_word(const char *word);
+
+/*
+ * 16, 20, 24, 28 or 32 bytes of entropy (32 for an ed25519 seed) <-> 12 to 24
+ * words. The indices variants return the word count; the entropy ones return
+ * its length in bytes. Decoding verifies the checksum. -1 on error.
+ */
+MELT_API int melt_entropy_to_indices(const unsigned char *entropy, int len, int indices[MELT_MAX_WORDS]);
+MELT_API int melt_indices_to_entropy(const int *indices, int nwords, unsigned char entropy[32], char *err);
+MELT_API int melt_entropy_to_mnemonic(const unsigned char *entropy, int len, char *out, size_t size);
+MELT_API int melt_mnemonic_to_entropy(const char *mnemonic, unsigned char entropy[32], char *err);
+
+MELT_API int melt_public_key(const unsigned char seed[32], unsigned char pk[32]);
+/* n of them at once, faster per key than one at a time */
+MELT_API int melt_public_keys(const unsigned char (*seeds)[32], int n, unsigned char (*pks)[32]);
+
+/*
+ * SLIP-10 Ed25519 child key (an ed25519 seed) at path below the master of a
+ * 16 to 64 byte seed, such as a mnemonic's entropy. Every index must be
+ * hardened (MELT_HARDENED | i). chain_code may be NULL. 0 or -1.
+ */
+#define MELT_HARDENED 0x80000000u
+MELT_API int melt_derive_key(const unsigned char *seed, int len, const unsigned int *path, int depth,
+                             unsigned char key[32], unsigned char chain_code[32], char *err);
+
+/*
+ * SLIP-39 Shamir shares of a 16 to 32 byte secret of even length, such as a
+ * mnemonic's entropy: count (at most MELT_MAX_SHARES) shares of one group,
+ * any threshold of which give it back, one NUL-terminated line of words
+ * each. The passphrase (NULL for none) encrypts the secret first with
+ * 10000 << exponent PBKDF2 iterations. Returns count or -1.
+ */
+#define MELT_MAX_SHARES 16
+#define MELT_SHARE_LEN 320 /* 33 words of at most 8 letters */
+MELT_API int melt_split_secret(const unsigned char *secret, int len, int threshold, int count, const char *passphrase,
+                               int exponent, char (*shares)[MELT_SHARE_LEN], char *err);
+
+/* The secret of n SLIP-39 shares, of one group or several; its length or -1 */
+MELT_API int melt_combine_shares(const char *const *shares, int n, const char *passphrase, unsigned char secret[32],
+                                 char *err);
+
+/*
+ * OpenSSH key text for seed and its public key pk (from melt_public_key), NUL
+ * terminated; returns its length or -1. A passphrase encrypts the private key
+ * with aes256-ctr and rounds of bcrypt.
+ */
+MELT_API int melt_format_private_key(const unsigned char seed[32], const unsigned char pk[32], const char *passphrase,
+                                     int rounds, char *out, size_t size, char *err);
+MELT_API int melt_format_public_key(const unsigned char pk[32], char *out, size_t size);
+
+/*
+ * Seeds of the keys in every armored block of an OpenSSH private key file
+ * held in text. work must hold at least len * 3 / 4 + 3 bytes and is wiped
+ * before returning. Returns the number of keys, -1, or MELT_NEED_PASSPHRASE.
+ */
+MELT_API int melt_parse_private_key(const char *text, size_t len, const char *passphrase, unsigned char (*seeds)[32],
+                                    int max_keys, unsigned char *work, size_t worksize, char *err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif